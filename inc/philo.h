@@ -6,7 +6,7 @@
 /*   By: eala-lah <eala-lah@student.hive.fi>        +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2025/04/01 15:28:41 by eala-lah          #+#    #+#             */
-/*   Updated: 2025/05/23 16:14:34 by eala-lah         ###   ########.fr       */
+/*   Updated: 2026/10/19 18:59:29 by eala-lah         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
@@ -21,15 +21,160 @@
 # include <unistd.h>
 # include <stdio.h>
 # include <stdlib.h>
+# include <string.h>
+# include <limits.h>
+# include <math.h>
+# include <fcntl.h>
 # include <pthread.h>
+# include <time.h>
+# include <sys/stat.h>
 # include <sys/time.h>
+# include <sys/syscall.h>
+# include <linux/futex.h>
+
+/* Magic number opening a replay log ("PHRL"), and the number of ints
+ * in its header */
+# define PHILO_MAGIC 0x4c524850
+# define PHILO_HEADLEN 8
+
+/* Timing profile limits: histogram bins per distribution, classes per
+ * profile, class name length and largest drawable duration in ms */
+# define PHILO_MAXBINS 16
+# define PHILO_MAXCLASSES 32
+# define PHILO_NAMELEN 32
+# define PHILO_MAXMS 2000000
+
+/* Timer wheel geometry: a tick of WHEEL_TICK microseconds, 256 one-tick
+ * slots at level 0, then WHEEL_LEVELS - 1 levels of 64 slots, each 64
+ * times coarser */
+# define WHEEL_TICK 100
+# define WHEEL_BITS0 8
+# define WHEEL_BITS 6
+# define WHEEL_LEVELS 4
+# define WHEEL_BASE 256
+# define WHEEL_SIZE 64
+# define WHEEL_SLOTS 448
+
+/* Timer wheel entry:
+ * - next, prev: links within a wheel slot
+ * - expires: deadline in wheel ticks since the wheel epoch
+ * - slot: wheel slot the timer is queued in
+ * - pending: still queued in the wheel
+ * - wake: futex word set and woken on expiry
+ */
+typedef struct s_timer
+{
+	struct s_timer	*next;
+	struct s_timer	*prev;
+	long long		expires;
+	int				slot;
+	int				pending;
+	int				*wake;
+}	t_timer;
+
+/* Hierarchical timer wheel serviced by a single timer thread:
+ * - slots: per-slot timer lists, level 0 first
+ * - epoch: monotonic start time in microseconds
+ * - clock: next tick to process
+ * - next: tick the timer thread sleeps until, -1 when idle
+ * - count: queued timers
+ * - stop: asks the timer thread to exit
+ * - lock, cond: guard the wheel and wake the timer thread early
+ */
+typedef struct s_wheel
+{
+	t_timer			*slots[WHEEL_SLOTS];
+	long long		epoch;
+	long long		clock;
+	long long		next;
+	int				count;
+	int				stop;
+	pthread_t		thread;
+	pthread_mutex_t	lock;
+	pthread_cond_t	cond;
+}	t_wheel;
+
+/* Growable int log for record/replay:
+ * - buf: recorded values
+ * - len, cap: used and allocated entries
+ * - pos: replay cursor
+ */
+typedef struct s_log
+{
+	int				*buf;
+	int				len;
+	int				cap;
+	int				pos;
+}	t_log;
+
+/* Duration distribution, in milliseconds:
+ * - kind: 'f' fixed a, 'u' uniform in [a, b], 'e' exponential with
+ *   mean a, 'h' empirical histogram
+ * - a, b: parameters, b holds the total weight for histograms
+ * - bins, vals, weights: histogram values and their weights
+ */
+typedef struct s_dist
+{
+	char			kind;
+	int				a;
+	int				b;
+	int				bins;
+	int				vals[PHILO_MAXBINS];
+	int				weights[PHILO_MAXBINS];
+}	t_dist;
+
+/* Philosopher class of a timing profile:
+ * - name: class name, "default" for the command line timings
+ * - count: philosophers requested by the profile
+ * - members: philosophers actually assigned
+ * - die, eat, sleep: timing distributions
+ */
+typedef struct s_class
+{
+	char			name[PHILO_NAMELEN];
+	int				count;
+	int				members;
+	t_dist			die;
+	t_dist			eat;
+	t_dist			sleep;
+}	t_class;
+
+/* Resource struct, handed out by the arbiter under arbiter_lock:
+ * - busy: currently held
+ * - reserved: stamp of the last hand-out pass that kept it for a
+ *   philosopher further ahead in the queue
+ * - users: number of philosophers sharing it
+ * - taken: successful acquisitions
+ * - contended: acquisitions that had to wait for another holder
+ */
+typedef struct s_fork
+{
+	int				busy;
+	unsigned int	reserved;
+	int				users;
+	long			taken;
+	long			contended;
+}	t_fork;
 
 /* Philosopher struct:
  * - last_meal: timestamp of last meal
  * - id: philosopher ID
  * - meals_eaten: count of meals eaten
+ * - time_to_die: this philosopher's starvation deadline
+ * - rng: xorshift state, only touched by the philosopher's thread
+ * - class: timing class from the profile
+ * - gaps: meal inter-arrival times in ms, kept with -s
+ * - num_res: number of resources needed to eat
+ * - res: sorted resource indices, a slice of the shared CSR list
+ * - waited, granted: arbiter state, see ft_request
+ * - deadline: death deadline the arbiter queue is sorted by
+ * - queue: next philosopher waiting for the arbiter
+ * - naps: ft_usleep end offsets from the start in wheel ticks, for
+ *   record/replay
+ * - timer: wheel entry for the current sleep
+ * - wake: futex word the philosopher blocks on while sleeping or
+ *   waiting for its resources
  * - thread: thread object
- * - left_fork, right_fork: mutex forks pointers
  * - data: pointer to shared data struct
  */
 typedef struct s_philo
@@ -37,20 +182,50 @@ typedef struct s_philo
 	long long		last_meal;
 	int				id;
 	int				meals_eaten;
+	int				time_to_die;
+	unsigned long	rng;
+	t_class			*class;
+	t_log			gaps;
+	int				num_res;
+	int				*res;
+	int				waited;
+	int				granted;
+	long long		deadline;
+	struct s_philo	*queue;
+	t_log			naps;
+	t_timer			timer;
+	int				wake;
 	pthread_t		thread;
-	pthread_mutex_t	*left_fork;
-	pthread_mutex_t	*right_fork;
 	struct s_data	*data;
 }	t_philo;
 
 /* Shared data struct:
  * - start_time: simulation start time
  * - num_philos: number of philosophers
- * - time_to_die/eat/sleep: timing params
+ * - time_to_die/eat/sleep: timing params of the default class
  * - must_eat: meals required to finish
  * - sim_stop: simulation stop flag
+ * - num_forks: number of shared resources
+ * - show_stats: print per-resource contention after the run
+ * - topology: topology spec from -t, NULL for the classic ring
+ * - record, replay: schedule log paths from -r and -p, or NULL
+ * - record_lost: a schedule log could not grow, the recording has gaps
+ * - profile: timing profile path from -c, or NULL
+ * - profile_hash: FNV-1a hash of the profile file, 0 without one
+ * - seed: PRNG seed, set by the profile
+ * - classes, num_classes: timing classes, the default one first
+ * - res_start, res_list: CSR adjacency, philosopher i needs
+ *   res_list[res_start[i]] up to res_list[res_start[i + 1]]
  * - write_lock, sim_stop_lock, last_meal_lock: mutexes for sync
- * - forks: array of fork mutexes
+ * - forks: array of resources
+ * - arbiter_lock: guards resources and the arbiter queue
+ * - hungry: philosophers waiting for their resources, earliest
+ *   deadline first
+ * - pass: stamp of the latest hand-out pass
+ * - grants: philosopher IDs in hand-out order, for record/replay
+ * - wheel: timer wheel all sleeps are scheduled on
+ * - monitor, monitor_wake: wheel entry and futex word of the monitor,
+ *   which sleeps until the earliest death deadline
  * - philos: array of philosopher structs
  */
 typedef struct s_data
@@ -62,30 +237,95 @@ typedef struct s_data
 	int				time_to_sleep;
 	int				must_eat;
 	int				sim_stop;
+	int				num_forks;
+	int				show_stats;
+	char			*topology;
+	char			*record;
+	char			*replay;
+	int				record_lost;
+	char			*profile;
+	unsigned int	profile_hash;
+	unsigned long	seed;
+	t_class			*classes;
+	int				num_classes;
+	int				*res_start;
+	int				*res_list;
 	pthread_mutex_t	write_lock;
 	pthread_mutex_t	sim_stop_lock;
 	pthread_mutex_t	last_meal_lock;
-	pthread_mutex_t	*forks;
+	t_fork			*forks;
+	pthread_mutex_t	arbiter_lock;
+	t_philo			*hungry;
+	unsigned int	pass;
+	t_log			grants;
 	t_philo			*philos;
+	t_wheel			wheel;
+	t_timer			monitor;
+	int				monitor_wake;
 }	t_data;
 
 /* Core simulation functions */
 long long	ft_time(void);
+long long	ft_utime(void);
 void		ft_printlog(t_philo *philo, char *msg);
 t_data		*ft_initdata(int ac, char **av);
 
+/* Argument parsing */
+int			ft_optcount(int ac, char **av);
+int			ft_parseopts(t_data *data, int ac, char **av, int i);
+int			ft_strncmp(const char *s1, const char *s2, size_t n);
+int			ft_isdigit(int c);
+int			ft_isspace(int c);
+
+/* Resource topology */
+int			ft_inittopology(t_data *data);
+int			ft_topofile(t_data *data, char *path);
+char		*ft_readfile(char *path, off_t *size);
+int			ft_nextint(char **cur, int *out);
+
+/* Timing profiles */
+int			ft_loadprofile(t_data *data);
+int			ft_parseprofile(t_data *data, char *cur);
+void		ft_initprofiles(t_data *data);
+unsigned long	ft_seed(unsigned long x);
+int			ft_draw(t_philo *philo, t_dist *dist);
+void		ft_report(t_data *data);
+
+/* Schedule record/replay */
+int			ft_logpush(t_log *log, int value);
+int			ft_tracesave(t_data *data);
+int			ft_traceload(t_data *data);
+
 /* Philosopher actions */
+int			ft_forks(t_philo *philo);
+void		ft_dropforks(t_philo *philo);
+void		ft_request(t_philo *philo);
+void		ft_grant(t_data *data);
 void		ft_eat(t_philo *philo);
 void		ft_sleepthink(t_philo *philo);
 
 /* Simulation control and monitoring */
-void		ft_threads(t_data *data, t_philo *philos);
+int			ft_threads(t_data *data, t_philo *philos);
 void		ft_usleep(t_philo *philo, long long duration_ms);
+void		ft_setstop(t_data *data);
+void		ft_wait(t_data *data, t_philo *philos);
+void		ft_wakemonitor(t_data *data);
 int			ft_status(t_data *data, t_philo *philos);
 int			ft_stoplock(t_philo *philo);
 int			ft_maxmeal(t_data *data, t_philo *philos);
 int			ft_atoi(char const *str);
 
+/* Timer wheel */
+long long	ft_mono(void);
+int			ft_wheelstart(t_data *data);
+void		ft_wheelstop(t_data *data);
+void		ft_wheeladd(t_wheel *wheel, t_timer *timer);
+void		ft_wheeldel(t_wheel *wheel, t_timer *timer);
+void		ft_wheeltick(t_wheel *wheel);
+int			ft_wheelsleep(t_data *data, t_timer *timer, long long us);
+void		ft_futexwait(int *addr, int val);
+void		ft_futexwake(int *addr);
+
 /* Cleanup simulation resources */
 void		ft_cleanup(t_data *data, t_philo *philos);
 
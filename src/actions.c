@@ -6,74 +6,57 @@
 /*   By: eala-lah <eala-lah@student.hive.fi>        +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2025/04/08 15:49:21 by eala-lah          #+#    #+#             */
-/*   Updated: 2025/05/23 16:16:15 by eala-lah         ###   ########.fr       */
+/*   Updated: 2026/10/19 18:29:07 by eala-lah         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
 #include "philo.h"
 
-/*
- * Attempts to acquire both forks for a philosopher.
- *
- * Locks left and right forks. If the simulation stopped, unlocks 
- * forks immediately and returns 0 to indicate failure.
- * Logs fork pickup twice on success.
- */
-int	ft_forks(t_philo *philo)
-{
-	pthread_mutex_lock(philo->left_fork);
-	if (ft_stoplock(philo))
-	{
-		pthread_mutex_unlock(philo->left_fork);
-		return (0);
-	}
-	pthread_mutex_lock(philo->right_fork);
-	if (ft_stoplock(philo))
-	{
-		pthread_mutex_unlock(philo->right_fork);
-		pthread_mutex_unlock(philo->left_fork);
-		return (0);
-	}
-	ft_printlog(philo, "has taken a fork");
-	ft_printlog(philo, "has taken a fork");
-	return (1);
-}
-
 /*
  * Simulates eating for a philosopher.
  *
  * Checks stop condition and fork acquisition. Updates last meal time 
- * and meal count with mutex protection. Sleeps for eating duration 
- * and releases forks after eating.
+ * and meal count with mutex protection, logging the time since the
+ * previous meal when stats are on. Sleeps for an eating duration
+ * drawn from the philosopher's class and releases all resources after
+ * eating. Wakes the monitor once the philosopher reaches must_eat.
  */
 void	ft_eat(t_philo *philo)
 {
+	long long	now;
+	int			done;
+
 	if (ft_stoplock(philo) || !ft_forks(philo))
 		return ;
 	pthread_mutex_lock(&philo->data->last_meal_lock);
-	philo->last_meal = ft_time();
+	now = ft_time();
+	if (philo->data->show_stats && philo->meals_eaten > 0)
+		ft_logpush(&philo->gaps, now - philo->last_meal);
+	philo->last_meal = now;
 	pthread_mutex_unlock(&philo->data->last_meal_lock);
 	ft_printlog(philo, "is eating");
-	ft_usleep(philo, philo->data->time_to_eat);
+	ft_usleep(philo, ft_draw(philo, &philo->class->eat));
 	pthread_mutex_lock(&philo->data->last_meal_lock);
 	philo->meals_eaten++;
+	done = (philo->meals_eaten == philo->data->must_eat);
 	pthread_mutex_unlock(&philo->data->last_meal_lock);
-	pthread_mutex_unlock(philo->right_fork);
-	pthread_mutex_unlock(philo->left_fork);
+	ft_dropforks(philo);
+	if (done)
+		ft_wakemonitor(philo->data);
 }
 
 /*
  * Simulates sleeping and thinking phases.
  *
- * Logs sleep, sleeps for the configured duration, then logs thinking 
- * unless the simulation is stopped in between.
+ * Logs sleep, sleeps for a duration drawn from the philosopher's class,
+ * then logs thinking unless the simulation is stopped in between.
  */
 void	ft_sleepthink(t_philo *philo)
 {
 	if (ft_stoplock(philo))
 		return ;
 	ft_printlog(philo, "is sleeping");
-	ft_usleep(philo, philo->data->time_to_sleep);
+	ft_usleep(philo, ft_draw(philo, &philo->class->sleep));
 	if (ft_stoplock(philo))
 		return ;
 	ft_printlog(philo, "is thinking");
@@ -114,3 +97,18 @@ long long	ft_time(void)
 	ms = (tv.tv_sec * 1000) + (tv.tv_usec / 1000);
 	return (ms);
 }
+
+/*
+ * Returns current time in microseconds.
+ *
+ * Same clock as ft_time, used where millisecond resolution is too
+ * coarse, such as recorded sleep durations.
+ */
+long long	ft_utime(void)
+{
+	struct timeval	tv;
+
+	if (gettimeofday(&tv, NULL) == -1)
+		return (-1);
+	return ((tv.tv_sec * 1000000LL) + tv.tv_usec);
+}
@@ -0,0 +1,158 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   arbiter.c                                          :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: eala-lah <eala-lah@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 18:40:53 by eala-lah          #+#    #+#             */
+/*   Updated: 2026/10/19 18:21:43 by eala-lah         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/*
+ * Checks whether every resource of a waiting philosopher is free and
+ * not reserved by someone ahead of it in this hand-out pass.
+ *
+ * If not, reserves them all with the pass stamp, so nobody behind it
+ * in the queue can take them first.
+ */
+static int	ft_grantable(t_data *data, t_philo *philo, unsigned int stamp)
+{
+	t_fork	*fork;
+	int		free;
+	int		i;
+
+	free = 1;
+	i = 0;
+	while (i < philo->num_res)
+	{
+		fork = &data->forks[philo->res[i++]];
+		if (fork->busy || fork->reserved == stamp)
+			free = 0;
+	}
+	i = 0;
+	while (!free && i < philo->num_res)
+		data->forks[philo->res[i++]].reserved = stamp;
+	return (free);
+}
+
+/*
+ * Hands a philosopher all its resources at once and wakes it.
+ *
+ * Updates the contention counters and, when recording, appends the
+ * philosopher's ID to the hand-out order. Only the granted philosopher
+ * is woken; if it is not blocked yet, its wake word is already set and
+ * no futex syscall is made.
+ */
+static void	ft_handout(t_data *data, t_philo *philo)
+{
+	t_fork	*fork;
+	int		i;
+
+	i = 0;
+	while (i < philo->num_res)
+	{
+		fork = &data->forks[philo->res[i++]];
+		fork->busy = 1;
+		fork->taken++;
+		fork->contended += philo->waited;
+	}
+	if (data->record && ft_logpush(&data->grants, philo->id))
+		__atomic_store_n(&data->record_lost, 1, __ATOMIC_SEQ_CST);
+	__atomic_store_n(&philo->granted, 1, __ATOMIC_SEQ_CST);
+	if (__atomic_exchange_n(&philo->wake, 1, __ATOMIC_SEQ_CST) == 0)
+		ft_futexwake(&philo->wake);
+}
+
+/*
+ * Hands out resources in the recorded order while replaying.
+ *
+ * Grants the philosopher the log names next as soon as it waits and
+ * its resources are free, then moves on to the following entry.
+ * Returns 0 once the log runs out, so normal hand-out takes over.
+ */
+static int	ft_replaygrant(t_data *data)
+{
+	t_philo	*philo;
+	t_philo	**link;
+
+	while (data->grants.pos < data->grants.len)
+	{
+		philo = &data->philos[data->grants.buf[data->grants.pos] - 1];
+		link = &data->hungry;
+		while (*link && *link != philo)
+			link = &(*link)->queue;
+		if (!*link || !ft_grantable(data, philo, ++data->pass))
+			return (1);
+		*link = philo->queue;
+		data->grants.pos++;
+		ft_handout(data, philo);
+	}
+	return (0);
+}
+
+/*
+ * Runs a hand-out pass over the waiting philosophers.
+ *
+ * Walks the queue front to back, granting everyone whose resources
+ * are free and not reserved by a philosopher ahead of it. Resources
+ * are only ever handed out all at once, so nobody holds one while
+ * waiting for another and no deadlock can form. Caller holds
+ * arbiter_lock.
+ */
+void	ft_grant(t_data *data)
+{
+	t_philo			*philo;
+	t_philo			**link;
+	unsigned int	stamp;
+
+	if (data->replay && ft_replaygrant(data))
+		return ;
+	stamp = ++data->pass;
+	link = &data->hungry;
+	while (*link)
+	{
+		philo = *link;
+		if (ft_grantable(data, philo, stamp))
+		{
+			*link = philo->queue;
+			ft_handout(data, philo);
+		}
+		else
+			link = &philo->queue;
+	}
+}
+
+/*
+ * Queues a philosopher for its resources and runs a hand-out pass.
+ *
+ * The queue is kept sorted by death deadline, last_meal plus the
+ * philosopher's own time_to_die, so the most urgent philosopher is
+ * served first and reserves what it needs against everyone behind
+ * it. Equal deadlines keep arrival order. last_meal is only written
+ * by the philosopher itself, so it is read here without
+ * last_meal_lock. If the pass could not grant it right away, the
+ * philosopher is marked as having waited for the contention stats.
+ */
+void	ft_request(t_philo *philo)
+{
+	t_data	*data;
+	t_philo	**link;
+
+	data = philo->data;
+	pthread_mutex_lock(&data->arbiter_lock);
+	philo->waited = 0;
+	philo->deadline = philo->last_meal + philo->time_to_die;
+	link = &data->hungry;
+	while (*link && (*link)->deadline <= philo->deadline)
+		link = &(*link)->queue;
+	philo->queue = *link;
+	*link = philo;
+	ft_grant(data);
+	if (!philo->granted)
+		philo->waited = 1;
+	pthread_mutex_unlock(&data->arbiter_lock);
+}
@@ -0,0 +1,125 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   classes.c                                          :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: eala-lah <eala-lah@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 14:32:10 by eala-lah          #+#    #+#             */
+/*   Updated: 2026/10/19 18:55:14 by eala-lah         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/*
+ * Sets up the default class from the command line timings.
+ */
+static void	ft_defaultclass(t_data *data, t_class *class)
+{
+	memset(class, 0, sizeof(t_class));
+	memcpy(class->name, "default", 8);
+	class->die.kind = 'f';
+	class->die.a = data->time_to_die;
+	class->eat.kind = 'f';
+	class->eat.a = data->time_to_eat;
+	class->sleep.kind = 'f';
+	class->sleep.a = data->time_to_sleep;
+}
+
+/*
+ * Returns the 32-bit FNV-1a hash of a buffer.
+ */
+static unsigned int	ft_hash(char *buf, off_t size)
+{
+	unsigned int	hash;
+	off_t			i;
+
+	hash = 2166136261u;
+	i = 0;
+	while (i < size)
+	{
+		hash ^= (unsigned char)buf[i++];
+		hash *= 16777619u;
+	}
+	return (hash);
+}
+
+/*
+ * Allocates the timing classes and loads the -c profile, if any.
+ *
+ * The default class always comes first. The profile is hashed before
+ * parsing, which tokenizes it in place, so replay logs can tell it
+ * apart. Returns 1 if the profile cannot be read or parsed.
+ */
+int	ft_loadprofile(t_data *data)
+{
+	char	*buf;
+	off_t	size;
+	int		bad;
+
+	data->classes = malloc(sizeof(t_class) * PHILO_MAXCLASSES);
+	if (!data->classes)
+		return (printf("What classes?\n"), 1);
+	ft_defaultclass(data, &data->classes[0]);
+	data->num_classes = 1;
+	if (!data->profile)
+		return (0);
+	buf = ft_readfile(data->profile, &size);
+	if (!buf)
+		return (printf("Cannot read profile %s\n", data->profile), 1);
+	data->profile_hash = ft_hash(buf, size);
+	bad = ft_parseprofile(data, buf);
+	free(buf);
+	if (bad)
+		return (printf("Bad profile %s\n", data->profile), 1);
+	return (0);
+}
+
+/*
+ * Assigns philosophers to classes in profile order.
+ *
+ * Each profile class takes the next count philosophers; whoever is
+ * left over belongs to the default class.
+ */
+static void	ft_assignclasses(t_data *data)
+{
+	int	i;
+	int	c;
+	int	n;
+
+	i = 0;
+	c = 1;
+	while (c < data->num_classes)
+	{
+		n = data->classes[c].count;
+		while (n-- > 0 && i < data->num_philos)
+			data->philos[i++].class = &data->classes[c];
+		c++;
+	}
+	while (i < data->num_philos)
+		data->philos[i++].class = &data->classes[0];
+}
+
+/*
+ * Gives every philosopher its class, PRNG state and own deadline.
+ *
+ * time_to_die is drawn once per philosopher, at least 1ms.
+ */
+void	ft_initprofiles(t_data *data)
+{
+	t_philo	*philo;
+	int		i;
+
+	ft_assignclasses(data);
+	i = 0;
+	while (i < data->num_philos)
+	{
+		philo = &data->philos[i++];
+		philo->class->members++;
+		philo->rng = ft_seed(data->seed + philo->id);
+		philo->time_to_die = ft_draw(philo, &philo->class->die);
+		if (philo->time_to_die < 1)
+			philo->time_to_die = 1;
+	}
+}
@@ -6,7 +6,7 @@
 /*   By: eala-lah <eala-lah@student.hive.fi>        +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2025/04/01 15:28:27 by eala-lah          #+#    #+#             */
-/*   Updated: 2025/05/23 16:02:16 by eala-lah         ###   ########.fr       */
+/*   Updated: 2026/10/19 18:20:28 by eala-lah         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
@@ -31,7 +31,8 @@ int	ft_stoplock(t_philo *philo)
 /*
  * Checks if a philosopher has died and stops simulation.
  *
- * Compares current time with last meal time. If time_to_die exceeded, 
+ * Compares current time with last meal time. If the philosopher's own
+ * time_to_die is exceeded,
  * sets sim_stop and prints death message with mutex protection.
  */
 int	ft_reaper(t_data *data, t_philo *philo)
@@ -45,7 +46,7 @@ int	ft_reaper(t_data *data, t_philo *philo)
 	last_meal = philo->last_meal;
 	pthread_mutex_unlock(&data->last_meal_lock);
 	current_time = ft_time();
-	if (current_time - last_meal < data->time_to_die)
+	if (current_time - last_meal < philo->time_to_die)
 		return (0);
 	pthread_mutex_lock(&data->sim_stop_lock);
 	if (data->sim_stop)
@@ -119,24 +120,29 @@ int	ft_status(t_data *data, t_philo *philos)
 /*
  * Frees memory and destroys all mutexes after simulation.
  *
- * Destroys forks mutexes, frees philosopher array, destroys other 
- * mutexes and frees data structures to clean up all resources.
+ * Frees schedule and meal logs and the philosopher array, destroys
+ * the mutexes and frees data, resource, topology and class arrays to
+ * clean up all resources.
  */
 void	ft_cleanup(t_data *data, t_philo *philos)
 {
 	int	i;
 
-	if (philos && data->num_philos > 1)
+	i = 0;
+	while (philos && i < data->num_philos)
 	{
-		i = 0;
-		while (i < data->num_philos)
-			pthread_mutex_destroy(&data->forks[i++]);
+		free(philos[i].gaps.buf);
+		free(philos[i++].naps.buf);
 	}
-	if (philos)
-		free(philos);
+	free(philos);
 	pthread_mutex_destroy(&data->write_lock);
 	pthread_mutex_destroy(&data->sim_stop_lock);
 	pthread_mutex_destroy(&data->last_meal_lock);
+	pthread_mutex_destroy(&data->arbiter_lock);
+	free(data->grants.buf);
 	free(data->forks);
+	free(data->res_start);
+	free(data->res_list);
+	free(data->classes);
 	free(data);
 }
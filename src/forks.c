@@ -0,0 +1,91 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   forks.c                                            :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: eala-lah <eala-lah@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 15:18:58 by eala-lah          #+#    #+#             */
+/*   Updated: 2026/10/19 18:27:17 by eala-lah         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/*
+ * Leaves the arbiter queue after the simulation stopped.
+ *
+ * A philosopher granted in the meantime gives its resources back.
+ * Always returns 0.
+ */
+static int	ft_withdraw(t_philo *philo)
+{
+	t_data	*data;
+	t_philo	**link;
+	int		granted;
+
+	data = philo->data;
+	pthread_mutex_lock(&data->arbiter_lock);
+	granted = philo->granted;
+	link = &data->hungry;
+	while (!granted && *link && *link != philo)
+		link = &(*link)->queue;
+	if (!granted && *link)
+		*link = philo->queue;
+	pthread_mutex_unlock(&data->arbiter_lock);
+	if (granted)
+		ft_dropforks(philo);
+	return (0);
+}
+
+/*
+ * Gives all resources of a philosopher back to the arbiter.
+ *
+ * Runs a hand-out pass right away, so whoever waited for them is
+ * woken.
+ */
+void	ft_dropforks(t_philo *philo)
+{
+	t_data	*data;
+	int		i;
+
+	data = philo->data;
+	pthread_mutex_lock(&data->arbiter_lock);
+	i = 0;
+	while (i < philo->num_res)
+		data->forks[philo->res[i++]].busy = 0;
+	__atomic_store_n(&philo->granted, 0, __ATOMIC_SEQ_CST);
+	ft_grant(data);
+	pthread_mutex_unlock(&data->arbiter_lock);
+}
+
+/*
+ * Acquires every resource a philosopher needs.
+ *
+ * Queues with the arbiter, then blocks on the philosopher's own wake
+ * word until it is granted. The wake word is cleared before the grant
+ * is checked, so a grant or ft_setstop in between is never missed.
+ * If the simulation stopped, leaves the queue and returns 0. Logs one
+ * pickup per resource.
+ */
+int	ft_forks(t_philo *philo)
+{
+	int	i;
+
+	ft_request(philo);
+	while (1)
+	{
+		__atomic_store_n(&philo->wake, 0, __ATOMIC_SEQ_CST);
+		if (__atomic_load_n(&philo->granted, __ATOMIC_SEQ_CST))
+			break ;
+		if (ft_stoplock(philo))
+			return (ft_withdraw(philo));
+		ft_futexwait(&philo->wake, 0);
+	}
+	if (ft_stoplock(philo))
+		return (ft_dropforks(philo), 0);
+	i = 0;
+	while (i++ < philo->num_res)
+		ft_printlog(philo, "has taken a fork");
+	return (1);
+}
@@ -6,44 +6,32 @@
 /*   By: eala-lah <eala-lah@student.hive.fi>        +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2025/04/04 15:30:10 by eala-lah          #+#    #+#             */
-/*   Updated: 2025/05/23 16:02:16 by eala-lah         ###   ########.fr       */
+/*   Updated: 2026/10/19 18:20:36 by eala-lah         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
 #include "philo.h"
 
 /*
- * Initializes fork mutexes for each philosopher.
+ * Allocates the resources of the topology.
  *
- * Allocates memory for forks and initializes one mutex per fork.
- * On failure, destroys initialized mutexes and frees the fork array.
+ * Resources are plain flags handed out by the arbiter, so zeroing the
+ * fork array is all the setup they need.
  */
 static int	ft_initforks(t_data *data)
 {
-	int	i;
-
-	data->forks = malloc(sizeof(pthread_mutex_t) * data->num_philos);
+	data->forks = malloc(sizeof(t_fork) * data->num_forks);
 	if (!data->forks)
 		return (printf("What forks?\n"), 1);
-	i = 0;
-	while (i < data->num_philos)
-	{
-		if (pthread_mutex_init(&data->forks[i], NULL) != 0)
-		{
-			while (i-- > 0)
-				pthread_mutex_destroy(&data->forks[i]);
-			free(data->forks);
-			return (printf("Failed mutex for fork %d\n", i), 1);
-		}
-		i++;
-	}
+	memset(data->forks, 0, sizeof(t_fork) * data->num_forks);
 	return (0);
 }
 
 /*
  * Initializes core simulation mutexes.
  *
- * Sets up write_lock, sim_stop_lock, and last_meal_lock in order.
+ * Sets up write_lock, sim_stop_lock, last_meal_lock and arbiter_lock
+ * in order.
  * On failure, any previously initialized mutexes are cleaned up.
  */
 static int	ft_initlocks(t_data *data)
@@ -61,29 +49,40 @@ static int	ft_initlocks(t_data *data)
 		pthread_mutex_destroy(&data->sim_stop_lock);
 		return (printf("Failed mutex for last_meal_lock\n"), 1);
 	}
+	if (pthread_mutex_init(&data->arbiter_lock, NULL) != 0)
+	{
+		pthread_mutex_destroy(&data->write_lock);
+		pthread_mutex_destroy(&data->sim_stop_lock);
+		pthread_mutex_destroy(&data->last_meal_lock);
+		return (printf("Failed mutex for arbiter_lock\n"), 1);
+	}
 	return (0);
 }
 
 /*
- * Assigns fork pointers and default values to each philosopher.
+ * Assigns resources and default values to each philosopher.
  *
- * Each philosopher receives left and right fork pointers in a circular
- * arrangement. Also sets ID, meal counter, thread, and timestamp.
+ * Each philosopher receives its slice of the CSR resource list and
+ * bumps the user count of every resource in it. Also sets ID and
+ * timestamp, everything else starts zeroed.
  */
 static int	ft_initphilos(t_data *data, t_philo *philos)
 {
 	int	i;
+	int	j;
 
+	memset(philos, 0, sizeof(t_philo) * data->num_philos);
 	i = 0;
 	while (i < data->num_philos)
 	{
 		philos[i].last_meal = ft_time();
 		philos[i].id = i + 1;
-		philos[i].meals_eaten = 0;
-		philos[i].thread = 0;
-		philos[i].left_fork = &data->forks[i];
-		philos[i].right_fork = &data->forks[(i + 1) % data->num_philos];
+		philos[i].res = &data->res_list[data->res_start[i]];
+		philos[i].num_res = data->res_start[i + 1] - data->res_start[i];
 		philos[i].data = data;
+		j = 0;
+		while (j < philos[i].num_res)
+			data->forks[philos[i].res[j++]].users++;
 		i++;
 	}
 	return (0);
@@ -103,6 +102,7 @@ static t_data	*ft_initmemory(int ac, char **av)
 	data = malloc(sizeof(t_data));
 	if (!data)
 		return (printf("What data?\n"), NULL);
+	memset(data, 0, sizeof(t_data));
 	data->start_time = ft_time();
 	data->num_philos = ft_atoi(av[1]);
 	data->time_to_die = ft_atoi(av[2]);
@@ -112,7 +112,6 @@ static t_data	*ft_initmemory(int ac, char **av)
 		data->must_eat = ft_atoi(av[5]);
 	else
 		data->must_eat = -1;
-	data->sim_stop = 0;
 	data->philos = malloc(sizeof(t_philo) * data->num_philos);
 	if (!data->philos)
 	{
@@ -125,32 +124,33 @@ static t_data	*ft_initmemory(int ac, char **av)
 /*
  * Full initialization routine for the simulation.
  *
- * Runs memory allocation, mutex and fork initialization, and 
- * philosopher setup in order. On failure at any step, cleans up
- * everything and returns NULL.
+ * Runs memory allocation, option parsing, topology construction,
+ * timing profile loading, mutex and fork initialization, philosopher
+ * setup and replay log loading in order.
+ * On failure at any step, cleans up everything and returns NULL.
  */
 t_data	*ft_initdata(int ac, char **av)
 {
 	t_data	*data;
+	int		pos;
 
-	data = ft_initmemory(ac, av);
+	pos = ft_optcount(ac, av);
+	data = ft_initmemory(pos, av);
 	if (!data)
 		return (NULL);
-	if (ft_initforks(data))
-		return (free(data), NULL);
-	if (ft_initlocks(data))
-	{
-		free(data->forks);
-		return (free(data), NULL);
-	}
-	if (ft_initphilos(data, data->philos))
+	if (ft_parseopts(data, ac, av, pos) || ft_inittopology(data)
+		|| ft_loadprofile(data) || ft_initforks(data) || ft_initlocks(data))
 	{
-		pthread_mutex_destroy(&data->write_lock);
-		pthread_mutex_destroy(&data->sim_stop_lock);
-		pthread_mutex_destroy(&data->last_meal_lock);
+		free(data->classes);
 		free(data->forks);
+		free(data->res_start);
+		free(data->res_list);
 		free(data->philos);
 		return (free(data), NULL);
 	}
+	ft_initphilos(data, data->philos);
+	ft_initprofiles(data);
+	if (data->replay && ft_traceload(data))
+		return (ft_cleanup(data, data->philos), NULL);
 	return (data);
 }
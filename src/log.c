@@ -0,0 +1,39 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   log.c                                              :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: eala-lah <eala-lah@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 18:28:15 by eala-lah          #+#    #+#             */
+/*   Updated: 2026/10/19 18:28:15 by eala-lah         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/*
+ * Appends a value to a log, doubling its capacity when full.
+ *
+ * Only ever called by the log's owner (the philosopher, or the holder
+ * of arbiter_lock), so no extra locking is needed. Returns 1 if the
+ * log could not grow and the value was dropped.
+ */
+int	ft_logpush(t_log *log, int value)
+{
+	int	*grown;
+
+	if (log->len == log->cap)
+	{
+		grown = malloc(sizeof(int) * (log->cap * 2 + 64));
+		if (!grown)
+			return (1);
+		if (log->len)
+			memcpy(grown, log->buf, sizeof(int) * log->len);
+		free(log->buf);
+		log->buf = grown;
+		log->cap = log->cap * 2 + 64;
+	}
+	log->buf[log->len++] = value;
+	return (0);
+}
@@ -6,7 +6,7 @@
 /*   By: eala-lah <eala-lah@student.hive.fi>        +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2025/04/01 15:28:49 by eala-lah          #+#    #+#             */
-/*   Updated: 2025/05/23 16:09:59 by eala-lah         ###   ########.fr       */
+/*   Updated: 2026/10/19 18:24:21 by eala-lah         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
@@ -67,17 +67,25 @@ int	ft_atoi(char const *str)
  * Entry point of the program.
  *
  * Validates input arguments, initializes simulation data, launches
- * philosopher threads, and performs cleanup after the simulation.
+ * philosopher threads, optionally prints resource and latency stats
+ * and saves the recorded schedule, and performs cleanup after the
+ * simulation. Exits with 1, without stats or a recording, if the
+ * simulation could not run, and with 1 if the schedule could not be
+ * saved.
  */
 int	main(int ac, char **av)
 {
 	t_data	*data;
+	int		pos;
+	int		ret;
 	int		i;
 
-	if (ac != 5 && ac != 6)
-		return (printf("Usage: ./philo nbr die eat sleep [must_eat]\n"), 1);
+	pos = ft_optcount(ac, av);
+	if (pos != 5 && pos != 6)
+		return (printf("Usage: ./philo nbr die eat sleep [must_eat] "
+				"[-t topology] [-s] [-r|-p log] [-c profile]\n"), 1);
 	i = 1;
-	while (i < ac)
+	while (i < pos)
 	{
 		if (ft_atoi(av[i++]) <= 0)
 			return (printf("These are not the args you were looking for\n"), 1);
@@ -85,7 +93,11 @@ int	main(int ac, char **av)
 	data = ft_initdata(ac, av);
 	if (!data)
 		return (1);
-	ft_threads(data, data->philos);
+	ret = ft_threads(data, data->philos);
+	if (!ret && data->show_stats)
+		ft_report(data);
+	if (!ret && data->record)
+		ret = ft_tracesave(data);
 	ft_cleanup(data, data->philos);
-	return (0);
+	return (ret);
 }
@@ -0,0 +1,106 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   monitor.c                                          :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: eala-lah <eala-lah@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 14:04:41 by eala-lah          #+#    #+#             */
+/*   Updated: 2026/10/19 18:42:29 by eala-lah         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/*
+ * Returns the earliest death deadline of all philosophers, in ms.
+ *
+ * Deadlines only move later as philosophers eat, so sleeping until
+ * this one never misses a death.
+ */
+static long long	ft_nextdeath(t_data *data)
+{
+	long long	next;
+	long long	deadline;
+	int			i;
+
+	next = LLONG_MAX;
+	pthread_mutex_lock(&data->last_meal_lock);
+	i = 0;
+	while (i < data->num_philos)
+	{
+		deadline = data->philos[i].last_meal + data->philos[i].time_to_die;
+		if (deadline < next)
+			next = deadline;
+		i++;
+	}
+	pthread_mutex_unlock(&data->last_meal_lock);
+	return (next);
+}
+
+/*
+ * Wakes the monitor early, so it rechecks the simulation status.
+ */
+void	ft_wakemonitor(t_data *data)
+{
+	if (__atomic_exchange_n(&data->monitor_wake, 1, __ATOMIC_SEQ_CST) == 0)
+		ft_futexwake(&data->monitor_wake);
+}
+
+/*
+ * Sets the stop flag and wakes every blocked philosopher.
+ *
+ * Each wake word is flipped to 1; only philosophers that were blocked
+ * on it (word was 0) need the futex syscall. The same word is what a
+ * philosopher blocks on while waiting for the arbiter.
+ */
+void	ft_setstop(t_data *data)
+{
+	int	i;
+
+	pthread_mutex_lock(&data->sim_stop_lock);
+	data->sim_stop = 1;
+	pthread_mutex_unlock(&data->sim_stop_lock);
+	i = 0;
+	while (i < data->num_philos)
+	{
+		if (__atomic_exchange_n(&data->philos[i].wake, 1,
+				__ATOMIC_SEQ_CST) == 0)
+			ft_futexwake(&data->philos[i].wake);
+		i++;
+	}
+}
+
+/*
+ * Waits for all philosopher threads to finish and monitors simulation.
+ *
+ * Checks if the simulation should stop due to death or completion,
+ * then sleeps on the timer wheel until the earliest death deadline,
+ * or until a philosopher reaching must_eat wakes it. When triggered,
+ * sets the stop flag, wakes every sleeping philosopher and joins all
+ * threads.
+ */
+void	ft_wait(t_data *data, t_philo *philos)
+{
+	long long	left;
+	int			i;
+
+	data->monitor.wake = &data->monitor_wake;
+	while (1)
+	{
+		__atomic_store_n(&data->monitor_wake, 0, __ATOMIC_SEQ_CST);
+		if (ft_status(data, philos))
+			break ;
+		left = ft_nextdeath(data) * 1000 - ft_utime();
+		if (left > 0)
+			ft_wheelsleep(data, &data->monitor, left);
+	}
+	ft_setstop(data);
+	i = 0;
+	while (i < data->num_philos)
+	{
+		if (philos[i].thread)
+			pthread_join(philos[i].thread, NULL);
+		i++;
+	}
+}
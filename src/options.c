@@ -0,0 +1,81 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   options.c                                          :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: eala-lah <eala-lah@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 11:14:51 by eala-lah          #+#    #+#             */
+/*   Updated: 2026/10/19 14:52:17 by eala-lah         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/*
+ * Compares at most n characters of two strings.
+ *
+ * Returns the difference of the first mismatching characters as
+ * unsigned values, or 0 if the compared prefixes are equal.
+ */
+int	ft_strncmp(const char *s1, const char *s2, size_t n)
+{
+	size_t	i;
+
+	i = 0;
+	while (i < n && (s1[i] || s2[i]))
+	{
+		if (s1[i] != s2[i])
+			return ((unsigned char)s1[i] - (unsigned char)s2[i]);
+		i++;
+	}
+	return (0);
+}
+
+/*
+ * Counts the positional arguments including the program name.
+ *
+ * Positional arguments end at the first argument starting with '-',
+ * which begins the optional flags.
+ */
+int	ft_optcount(int ac, char **av)
+{
+	int	i;
+
+	i = 1;
+	while (i < ac && av[i][0] != '-')
+		i++;
+	return (i);
+}
+
+/*
+ * Parses optional flags following the positional arguments.
+ *
+ * -t <spec> selects the resource topology, -s prints per-resource
+ * contention stats after the run, -r <file> records the schedule and
+ * -p <file> replays one, -c <file> loads a timing profile. Returns 1
+ * on an unknown or incomplete flag,
+ * or when recording and replaying at once.
+ */
+int	ft_parseopts(t_data *data, int ac, char **av, int i)
+{
+	while (i < ac)
+	{
+		if (!ft_strncmp(av[i], "-s", 3))
+			data->show_stats = 1;
+		else if (!ft_strncmp(av[i], "-t", 3) && i + 1 < ac)
+			data->topology = av[++i];
+		else if (!ft_strncmp(av[i], "-r", 3) && i + 1 < ac)
+			data->record = av[++i];
+		else if (!ft_strncmp(av[i], "-p", 3) && i + 1 < ac)
+			data->replay = av[++i];
+		else if (!ft_strncmp(av[i], "-c", 3) && i + 1 < ac)
+			data->profile = av[++i];
+		else
+			return (printf("Unknown option %s\n", av[i]), 1);
+		i++;
+	}
+	if (data->record && data->replay)
+		return (printf("Cannot record and replay at once\n"), 1);
+	return (0);
+}
@@ -0,0 +1,167 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   profile.c                                          :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: eala-lah <eala-lah@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 10:10:44 by eala-lah          #+#    #+#             */
+/*   Updated: 2026/10/19 10:10:44 by eala-lah         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/*
+ * Returns the next whitespace separated token and advances the cursor.
+ *
+ * Skips '#' comments up to the end of the line. The token is
+ * NUL-terminated in place. Returns NULL at the end of the buffer.
+ */
+static char	*ft_nexttoken(char **cur)
+{
+	char	*tok;
+
+	while (**cur && (ft_isspace(**cur) || **cur == '#'))
+	{
+		if (**cur == '#')
+			while (**cur && **cur != '\n')
+				(*cur)++;
+		else
+			(*cur)++;
+	}
+	if (!**cur)
+		return (NULL);
+	tok = *cur;
+	while (**cur && !ft_isspace(**cur))
+		(*cur)++;
+	if (**cur)
+		*(*cur)++ = '\0';
+	return (tok);
+}
+
+/*
+ * Parses an empirical histogram as value/weight pairs split by commas.
+ *
+ * Returns 1 on bad syntax, too many bins, values out of range or a
+ * total weight that is zero or overflows.
+ */
+static int	ft_parsehist(char *s, t_dist *dist)
+{
+	int	*val;
+	int	*weight;
+
+	dist->kind = 'h';
+	while (dist->bins < PHILO_MAXBINS)
+	{
+		val = &dist->vals[dist->bins];
+		weight = &dist->weights[dist->bins++];
+		if (!ft_nextint(&s, val) || *s++ != '/' || !ft_nextint(&s, weight)
+			|| *val > PHILO_MAXMS || *weight > INT_MAX - dist->b)
+			return (1);
+		dist->b += *weight;
+		if (*s == '\0')
+			return (dist->b == 0);
+		if (*s++ != ',')
+			return (1);
+	}
+	return (1);
+}
+
+/*
+ * Parses a distribution token.
+ *
+ * Accepts <ms> or fixed:<ms>, uniform:<min>:<max>, exp:<mean> and
+ * hist:<ms>/<weight>,... Returns 1 on a missing or malformed token.
+ */
+static int	ft_parsedist(char *tok, t_dist *dist)
+{
+	memset(dist, 0, sizeof(t_dist));
+	dist->kind = 'f';
+	if (!tok)
+		return (1);
+	if (!ft_strncmp(tok, "hist:", 5))
+		return (ft_parsehist(tok + 5, dist));
+	if (!ft_strncmp(tok, "fixed:", 6))
+		tok += 6;
+	else if (!ft_strncmp(tok, "uniform:", 8))
+		dist->kind = 'u';
+	else if (!ft_strncmp(tok, "exp:", 4))
+		dist->kind = 'e';
+	if (dist->kind == 'u')
+		tok += 8;
+	else if (dist->kind == 'e')
+		tok += 4;
+	if (!ft_nextint(&tok, &dist->a))
+		return (1);
+	if (dist->kind == 'u' && (*tok++ != ':'
+			|| !ft_nextint(&tok, &dist->b) || dist->b < dist->a))
+		return (1);
+	return (*tok != '\0' || dist->a > PHILO_MAXMS || dist->b > PHILO_MAXMS);
+}
+
+/*
+ * Parses the fields following a "class" keyword.
+ *
+ * Reads the name, the philosopher count, then the die, eat and sleep
+ * distributions. Returns 1 on bad input or too many classes.
+ */
+static int	ft_parseclass(t_data *data, char **cur)
+{
+	t_class	*class;
+	char	*tok;
+	int		i;
+
+	if (data->num_classes >= PHILO_MAXCLASSES)
+		return (1);
+	class = &data->classes[data->num_classes++];
+	memset(class, 0, sizeof(t_class));
+	tok = ft_nexttoken(cur);
+	if (!tok)
+		return (1);
+	i = 0;
+	while (tok[i] && i < PHILO_NAMELEN - 1)
+	{
+		class->name[i] = tok[i];
+		i++;
+	}
+	tok = ft_nexttoken(cur);
+	if (!tok || !ft_nextint(&tok, &class->count) || *tok)
+		return (1);
+	return (ft_parsedist(ft_nexttoken(cur), &class->die)
+		|| ft_parsedist(ft_nexttoken(cur), &class->eat)
+		|| ft_parsedist(ft_nexttoken(cur), &class->sleep));
+}
+
+/*
+ * Parses a timing profile buffer.
+ *
+ * Holds "seed <n>" and "class <name> <count> <die> <eat> <sleep>"
+ * entries. Returns 1 on an unknown keyword or malformed entry.
+ */
+int	ft_parseprofile(t_data *data, char *cur)
+{
+	char	*tok;
+	int		seed;
+
+	tok = ft_nexttoken(&cur);
+	while (tok)
+	{
+		if (!ft_strncmp(tok, "class", 6))
+		{
+			if (ft_parseclass(data, &cur))
+				return (1);
+		}
+		else if (!ft_strncmp(tok, "seed", 5))
+		{
+			tok = ft_nexttoken(&cur);
+			if (!tok || !ft_nextint(&tok, &seed) || *tok)
+				return (1);
+			data->seed = seed;
+		}
+		else
+			return (1);
+		tok = ft_nexttoken(&cur);
+	}
+	return (0);
+}
@@ -0,0 +1,87 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   random.c                                           :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: eala-lah <eala-lah@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 13:42:35 by eala-lah          #+#    #+#             */
+/*   Updated: 2026/10/19 13:42:35 by eala-lah         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/*
+ * Scrambles a seed with splitmix64.
+ *
+ * Used to derive well spread, non-zero xorshift states from
+ * consecutive philosopher IDs.
+ */
+unsigned long	ft_seed(unsigned long x)
+{
+	x += 0x9E3779B97F4A7C15UL;
+	x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9UL;
+	x = (x ^ (x >> 27)) * 0x94D049BB133111EBUL;
+	x ^= x >> 31;
+	if (x == 0)
+		return (1);
+	return (x);
+}
+
+/*
+ * Returns the next value of the philosopher's xorshift64* generator.
+ *
+ * The state lives in the philosopher and is only used by its own
+ * thread, so no locking is needed.
+ */
+static unsigned long	ft_rand(t_philo *philo)
+{
+	unsigned long	x;
+
+	x = philo->rng;
+	x ^= x >> 12;
+	x ^= x << 25;
+	x ^= x >> 27;
+	philo->rng = x;
+	return (x * 0x2545F4914F6CDD1DUL);
+}
+
+/*
+ * Draws an exponential duration with the given mean.
+ *
+ * Inverts the CDF on a uniform value in (0, 1] built from the top 53
+ * bits of the generator. Capped at PHILO_MAXMS.
+ */
+static int	ft_drawexp(t_philo *philo, int mean)
+{
+	double	u;
+
+	u = ((ft_rand(philo) >> 11) + 1.0) / 9007199254740992.0;
+	u = -mean * log(u);
+	if (u > PHILO_MAXMS)
+		return (PHILO_MAXMS);
+	return ((int)(u + 0.5));
+}
+
+/*
+ * Draws a duration in milliseconds from a distribution.
+ */
+int	ft_draw(t_philo *philo, t_dist *dist)
+{
+	unsigned long	r;
+	int				i;
+
+	if (dist->kind == 'u')
+		return (dist->a + ft_rand(philo)
+			% (unsigned long)(dist->b - dist->a + 1));
+	if (dist->kind == 'e')
+		return (ft_drawexp(philo, dist->a));
+	if (dist->kind != 'h')
+		return (dist->a);
+	r = ft_rand(philo) % (unsigned long)dist->b;
+	i = 0;
+	while (r >= (unsigned long)dist->weights[i])
+		r -= dist->weights[i++];
+	return (dist->vals[i]);
+}
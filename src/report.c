@@ -0,0 +1,130 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   report.c                                           :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: eala-lah <eala-lah@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 17:11:21 by eala-lah          #+#    #+#             */
+/*   Updated: 2026/10/19 18:39:51 by eala-lah         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/*
+ * Orders ints ascending for qsort.
+ */
+static int	ft_cmpint(const void *a, const void *b)
+{
+	int	x;
+	int	y;
+
+	x = *(const int *)a;
+	y = *(const int *)b;
+	return ((x > y) - (x < y));
+}
+
+/*
+ * Collects the meal inter-arrival times of every philosopher in a
+ * class into one array, storing its length in len.
+ */
+static int	*ft_classgaps(t_data *data, t_class *class, int *len)
+{
+	int	*gaps;
+	int	i;
+
+	*len = 0;
+	i = -1;
+	while (++i < data->num_philos)
+		if (data->philos[i].class == class)
+			*len += data->philos[i].gaps.len;
+	gaps = malloc(sizeof(int) * (*len + 1));
+	if (!gaps)
+		return (NULL);
+	*len = 0;
+	i = -1;
+	while (++i < data->num_philos)
+	{
+		if (data->philos[i].class == class && data->philos[i].gaps.len)
+		{
+			memcpy(gaps + *len, data->philos[i].gaps.buf,
+				sizeof(int) * data->philos[i].gaps.len);
+			*len += data->philos[i].gaps.len;
+		}
+	}
+	return (gaps);
+}
+
+/*
+ * Returns the nearest-rank percentile, given in tenths of a percent,
+ * of a sorted array.
+ */
+static int	ft_pct(int *sorted, int len, int permille)
+{
+	long long	rank;
+
+	rank = ((long long)len * permille + 999) / 1000;
+	if (rank < 1)
+		rank = 1;
+	return (sorted[rank - 1]);
+}
+
+/*
+ * Prints per-resource contention stats.
+ *
+ * Called after all threads are joined, so counters are read without
+ * locking.
+ */
+static void	ft_forkstats(t_data *data)
+{
+	int		i;
+	t_fork	*fork;
+	double	rate;
+
+	printf("fork\tusers\ttaken\tcontended\n");
+	i = 0;
+	while (i < data->num_forks)
+	{
+		fork = &data->forks[i];
+		rate = 0.0;
+		if (fork->taken > 0)
+			rate = 100.0 * fork->contended / fork->taken;
+		printf("%d\t%d\t%ld\t%ld (%.1f%%)\n", i, fork->users,
+			fork->taken, fork->contended, rate);
+		i++;
+	}
+}
+
+/*
+ * Prints resource contention, then meal inter-arrival tail latency
+ * per philosopher class.
+ *
+ * Called after all threads are joined. Only gaps between two meals
+ * are counted, so classes that never ate twice are skipped.
+ */
+void	ft_report(t_data *data)
+{
+	t_class	*class;
+	int		*gaps;
+	int		len;
+	int		i;
+
+	ft_forkstats(data);
+	printf("class\tphilos\tgaps\tp50\tp90\tp99\tp99.9\tmax\n");
+	i = 0;
+	while (i < data->num_classes)
+	{
+		class = &data->classes[i++];
+		gaps = ft_classgaps(data, class, &len);
+		if (gaps && len > 0)
+		{
+			qsort(gaps, len, sizeof(int), ft_cmpint);
+			printf("%s\t%d\t%d\t%d\t%d\t%d\t%d\t%d\n", class->name,
+				class->members, len, ft_pct(gaps, len, 500),
+				ft_pct(gaps, len, 900), ft_pct(gaps, len, 990),
+				ft_pct(gaps, len, 999), gaps[len - 1]);
+		}
+		free(gaps);
+	}
+}
@@ -0,0 +1,98 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   sleep.c                                            :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: eala-lah <eala-lah@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 16:25:26 by eala-lah          #+#    #+#             */
+/*   Updated: 2026/10/19 18:57:06 by eala-lah         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/*
+ * Blocks while the futex word still holds val.
+ *
+ * Returns early on a wake, a signal or a changed value, so callers
+ * recheck their condition in a loop.
+ */
+void	ft_futexwait(int *addr, int val)
+{
+	syscall(SYS_futex, addr, FUTEX_WAIT_PRIVATE, val, NULL, NULL, 0);
+}
+
+/*
+ * Wakes every thread blocked on the futex word.
+ */
+void	ft_futexwake(int *addr)
+{
+	syscall(SYS_futex, addr, FUTEX_WAKE_PRIVATE, INT_MAX, NULL, NULL, 0);
+}
+
+/*
+ * Sleeps on the timer wheel for at least us microseconds.
+ *
+ * Registers the deadline, waking the timer thread if it is earlier
+ * than the one it sleeps until, then blocks on the timer's futex
+ * word. Callers clear the wake word before calling, and the stop flag
+ * is checked after that, so a concurrent ft_setstop or early wake is
+ * never missed. Returns 1 if the timer fired, 0 if the sleep was cut
+ * short.
+ */
+int	ft_wheelsleep(t_data *data, t_timer *timer, long long us)
+{
+	t_wheel	*wheel;
+	int		fired;
+
+	wheel = &data->wheel;
+	pthread_mutex_lock(&wheel->lock);
+	timer->expires = (ft_mono() - wheel->epoch + us + WHEEL_TICK - 1)
+		/ WHEEL_TICK;
+	ft_wheeladd(wheel, timer);
+	if (wheel->next < 0 || timer->expires < wheel->next)
+		pthread_cond_signal(&wheel->cond);
+	pthread_mutex_unlock(&wheel->lock);
+	while (!__atomic_load_n(timer->wake, __ATOMIC_SEQ_CST)
+		&& !ft_stoplock(data->philos))
+		ft_futexwait(timer->wake, 0);
+	pthread_mutex_lock(&wheel->lock);
+	fired = !timer->pending;
+	if (timer->pending)
+		ft_wheeldel(wheel, timer);
+	pthread_mutex_unlock(&wheel->lock);
+	return (fired);
+}
+
+/*
+ * Sleeps for a duration in milliseconds without polling.
+ *
+ * The philosopher blocks until the timer thread fires its deadline
+ * or the stop flag wakes it. Naps are logged as their end offset from
+ * the simulation start, in wheel ticks, so a replay sleeps until the
+ * recorded moment and wheel overshoot cannot add up over a run. A nap
+ * cut short by the stop flag is not logged, and one that does not fit
+ * in the log marks the whole recording as lost.
+ */
+void	ft_usleep(t_philo *philo, long long duration_ms)
+{
+	long long	base;
+	long long	target;
+	t_log		*naps;
+
+	naps = &philo->naps;
+	base = philo->data->start_time * 1000;
+	target = duration_ms * 1000;
+	if (philo->data->replay && naps->pos < naps->len)
+		target = naps->buf[naps->pos++] * (long long)WHEEL_TICK
+			- (ft_utime() - base);
+	philo->timer.wake = &philo->wake;
+	__atomic_store_n(&philo->wake, 0, __ATOMIC_SEQ_CST);
+	if (ft_stoplock(philo))
+		return ;
+	if (ft_wheelsleep(philo->data, &philo->timer, target)
+		&& philo->data->record
+		&& ft_logpush(naps, (ft_utime() - base) / WHEEL_TICK))
+		__atomic_store_n(&philo->data->record_lost, 1, __ATOMIC_SEQ_CST);
+}
@@ -0,0 +1,151 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   timer.c                                            :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: eala-lah <eala-lah@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 10:03:40 by eala-lah          #+#    #+#             */
+/*   Updated: 2026/10/19 18:57:37 by eala-lah         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/*
+ * Returns monotonic time in microseconds.
+ *
+ * The timer wheel runs on this clock so wall clock jumps cannot
+ * fire or delay sleeps.
+ */
+long long	ft_mono(void)
+{
+	struct timespec	ts;
+
+	if (clock_gettime(CLOCK_MONOTONIC, &ts) == -1)
+		return (-1);
+	return ((ts.tv_sec * 1000000LL) + (ts.tv_nsec / 1000));
+}
+
+/*
+ * Finds the next tick the timer thread must wake up for.
+ *
+ * That is the first non-empty level 0 slot within one round of the
+ * clock, or the first level 0 wrap that has something to cascade,
+ * whichever comes first. A wrap only cascades when its level 1 slot
+ * holds timers or level 1 wraps too; other wraps are skipped, and
+ * the ticks in between are processed when the thread wakes.
+ */
+static long long	ft_wheelnext(t_wheel *wheel)
+{
+	long long	tick;
+	long long	round;
+	int			idx;
+
+	tick = wheel->clock;
+	round = wheel->clock + WHEEL_BASE;
+	while (1)
+	{
+		idx = (tick >> WHEEL_BITS0) & (WHEEL_SIZE - 1);
+		if ((tick & (WHEEL_BASE - 1)) == 0
+			&& (idx == 0 || wheel->slots[WHEEL_BASE + idx]))
+			return (tick);
+		if (tick < round && wheel->slots[tick & (WHEEL_BASE - 1)])
+			return (tick);
+		if (tick < round)
+			tick++;
+		else
+			tick = (tick | (WHEEL_BASE - 1)) + 1;
+	}
+}
+
+/*
+ * Main routine of the timer thread.
+ *
+ * Processes every tick up to now, then blocks until the next tick
+ * that has work, or indefinitely while the wheel is empty. Sleepers
+ * registering an earlier deadline signal the condition to wake it
+ * early, so the thread only wakes for actual timer events.
+ */
+static void	*ft_wheelloop(void *arg)
+{
+	t_wheel			*wheel;
+	struct timespec	ts;
+	long long		at;
+
+	wheel = arg;
+	pthread_mutex_lock(&wheel->lock);
+	while (!wheel->stop)
+	{
+		at = (ft_mono() - wheel->epoch) / WHEEL_TICK;
+		while (wheel->clock <= at)
+			ft_wheeltick(wheel);
+		wheel->next = -1;
+		if (wheel->count == 0)
+			pthread_cond_wait(&wheel->cond, &wheel->lock);
+		else
+		{
+			wheel->next = ft_wheelnext(wheel);
+			at = wheel->epoch + wheel->next * WHEEL_TICK;
+			ts.tv_sec = at / 1000000;
+			ts.tv_nsec = (at % 1000000) * 1000;
+			pthread_cond_timedwait(&wheel->cond, &wheel->lock, &ts);
+		}
+	}
+	pthread_mutex_unlock(&wheel->lock);
+	return (NULL);
+}
+
+/*
+ * Initializes the timer wheel and starts its thread.
+ *
+ * The condition waits on the monotonic clock to match the wheel
+ * epoch. On failure, cleans up what was created and returns 1.
+ */
+int	ft_wheelstart(t_data *data)
+{
+	t_wheel				*wheel;
+	pthread_condattr_t	attr;
+
+	wheel = &data->wheel;
+	wheel->epoch = ft_mono();
+	wheel->next = -1;
+	if (pthread_mutex_init(&wheel->lock, NULL) != 0)
+		return (printf("Failed mutex for timer wheel\n"), 1);
+	pthread_condattr_init(&attr);
+	pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+	if (pthread_cond_init(&wheel->cond, &attr) != 0)
+	{
+		pthread_condattr_destroy(&attr);
+		pthread_mutex_destroy(&wheel->lock);
+		return (printf("Failed condition for timer wheel\n"), 1);
+	}
+	pthread_condattr_destroy(&attr);
+	if (pthread_create(&wheel->thread, NULL, ft_wheelloop, wheel) != 0)
+	{
+		pthread_cond_destroy(&wheel->cond);
+		pthread_mutex_destroy(&wheel->lock);
+		return (printf("Error creating timer thread\n"), 1);
+	}
+	return (0);
+}
+
+/*
+ * Stops and joins the timer thread, then destroys the wheel locks.
+ *
+ * Called once every philosopher has returned, so no timer is left
+ * queued.
+ */
+void	ft_wheelstop(t_data *data)
+{
+	t_wheel	*wheel;
+
+	wheel = &data->wheel;
+	pthread_mutex_lock(&wheel->lock);
+	wheel->stop = 1;
+	pthread_cond_signal(&wheel->cond);
+	pthread_mutex_unlock(&wheel->lock);
+	pthread_join(wheel->thread, NULL);
+	pthread_cond_destroy(&wheel->cond);
+	pthread_mutex_destroy(&wheel->lock);
+}
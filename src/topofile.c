@@ -0,0 +1,137 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   topofile.c                                         :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: eala-lah <eala-lah@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 18:12:46 by eala-lah          #+#    #+#             */
+/*   Updated: 2026/10/19 18:21:20 by eala-lah         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/*
+ * Reads a whole file into a NUL-terminated buffer.
+ *
+ * Sizes the buffer with fstat and reads until the end, storing the
+ * number of bytes read in size. Returns NULL if the file cannot be
+ * opened or memory runs out.
+ */
+char	*ft_readfile(char *path, off_t *size)
+{
+	struct stat	st;
+	char		*buf;
+	ssize_t		got;
+	off_t		len;
+	int			fd;
+
+	fd = open(path, O_RDONLY);
+	if (fd < 0)
+		return (NULL);
+	if (fstat(fd, &st) != 0)
+		return (close(fd), NULL);
+	buf = malloc(st.st_size + 1);
+	len = 0;
+	while (buf && len < st.st_size)
+	{
+		got = read(fd, buf + len, st.st_size - len);
+		if (got <= 0)
+			break ;
+		len += got;
+	}
+	close(fd);
+	if (buf)
+		buf[len] = '\0';
+	*size = len;
+	return (buf);
+}
+
+/*
+ * Parses the next non-negative integer and advances the cursor.
+ *
+ * Skips leading whitespace. Returns 0 if no number follows or the
+ * value does not fit in an int.
+ */
+int	ft_nextint(char **cur, int *out)
+{
+	long long	n;
+
+	while (**cur && ft_isspace(**cur))
+		(*cur)++;
+	if (!ft_isdigit(**cur))
+		return (0);
+	n = 0;
+	while (ft_isdigit(**cur) && n <= INT_MAX)
+		n = n * 10 + *(*cur)++ - '0';
+	if (n > INT_MAX)
+		return (0);
+	*out = (int)n;
+	return (1);
+}
+
+/*
+ * Parses a topology file in one of two passes.
+ *
+ * The first pass validates and computes row offsets, the second
+ * (fill set) copies resource indices into res_list. Anything but
+ * whitespace after the last philosopher's row is rejected, so a file
+ * written for another philosopher count is reported.
+ */
+static int	ft_parsetopo(t_data *data, char *cur, int fill)
+{
+	int	i;
+	int	k;
+	int	r;
+	int	v;
+
+	if (!ft_nextint(&cur, &data->num_forks) || data->num_forks < 1)
+		return (1);
+	i = -1;
+	while (++i < data->num_philos)
+	{
+		if (!ft_nextint(&cur, &k) || k < 1
+			|| data->res_start[i] > INT_MAX - k)
+			return (1);
+		if (!fill)
+			data->res_start[i + 1] = data->res_start[i] + k;
+		r = data->res_start[i];
+		while (k-- > 0)
+		{
+			if (!ft_nextint(&cur, &v) || v >= data->num_forks)
+				return (1);
+			if (fill)
+				data->res_list[r++] = v;
+		}
+	}
+	return (ft_nextint(&cur, &v) || *cur != '\0');
+}
+
+/*
+ * Loads a topology from a file.
+ *
+ * Format: the number of resources, then one line per philosopher
+ * holding a count k followed by k resource indices.
+ */
+int	ft_topofile(t_data *data, char *path)
+{
+	char	*buf;
+	off_t	size;
+
+	buf = ft_readfile(path, &size);
+	if (!buf)
+		return (printf("Cannot read topology %s\n", path), 1);
+	data->res_start = malloc(sizeof(int) * (data->num_philos + 1));
+	if (data->res_start)
+	{
+		data->res_start[0] = 0;
+		if (!ft_parsetopo(data, buf, 0))
+			data->res_list = malloc(sizeof(int)
+					* data->res_start[data->num_philos]);
+	}
+	if (!data->res_list || ft_parsetopo(data, buf, 1))
+		return (free(buf), printf("Bad topology %s\n", path), 1);
+	free(buf);
+	return (0);
+}
@@ -0,0 +1,167 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   topology.c                                         :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: eala-lah <eala-lah@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 17:28:31 by eala-lah          #+#    #+#             */
+/*   Updated: 2026/10/19 18:15:14 by eala-lah         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/*
+ * Allocates a CSR adjacency with a fixed degree per philosopher.
+ *
+ * Sets the resource count and the row offsets, leaving res_list to
+ * be filled by the generator.
+ */
+static int	ft_topoalloc(t_data *data, int degree, int num_forks)
+{
+	int	i;
+
+	data->num_forks = num_forks;
+	data->res_start = malloc(sizeof(int) * (data->num_philos + 1));
+	data->res_list = malloc(sizeof(int) * data->num_philos * degree);
+	if (!data->res_start || !data->res_list)
+		return (printf("What topology?\n"), 1);
+	i = 0;
+	while (i <= data->num_philos)
+	{
+		data->res_start[i] = i * degree;
+		i++;
+	}
+	return (0);
+}
+
+/*
+ * Fills a generated topology.
+ *
+ * Ring: forks i and i + 1. Grid: a torus of rows of k, each
+ * philosopher needs its own node, the next node in its row and the
+ * node below. Hub: ring forks plus one of k shared hub resources.
+ */
+static int	ft_topogen(t_data *data, char kind, int k)
+{
+	int	i;
+	int	n;
+	int	*r;
+
+	n = data->num_philos;
+	i = 0;
+	while (i < n)
+	{
+		r = &data->res_list[data->res_start[i]];
+		r[0] = i;
+		if (kind == 'g')
+			r[1] = i - i % k + (i % k + 1) % k;
+		else
+			r[1] = (i + 1) % n;
+		if (kind == 'g')
+			r[2] = (i + k) % n;
+		else if (kind == 'h')
+			r[2] = n + i % k;
+		i++;
+	}
+	return (0);
+}
+
+/*
+ * Sorts a short list of resource indices in place.
+ *
+ * Insertion sort, as each philosopher only needs a handful of
+ * resources.
+ */
+static void	ft_sortrange(int *arr, int len)
+{
+	int	i;
+	int	j;
+	int	key;
+
+	i = 1;
+	while (i < len)
+	{
+		key = arr[i];
+		j = i - 1;
+		while (j >= 0 && arr[j] > key)
+		{
+			arr[j + 1] = arr[j];
+			j--;
+		}
+		arr[j + 1] = key;
+		i++;
+	}
+}
+
+/*
+ * Sorts and deduplicates every philosopher's resource list.
+ *
+ * A resource listed twice would be counted twice by the arbiter and
+ * the stats, so rows are compacted in place and the offsets
+ * rewritten.
+ */
+static int	ft_csrsort(t_data *data)
+{
+	int	i;
+	int	j;
+	int	w;
+	int	end;
+	int	*list;
+
+	list = data->res_list;
+	w = 0;
+	i = -1;
+	while (++i < data->num_philos)
+	{
+		j = data->res_start[i];
+		end = data->res_start[i + 1];
+		ft_sortrange(list + j, end - j);
+		data->res_start[i] = w;
+		while (j < end)
+		{
+			if (w == data->res_start[i] || list[j] != list[w - 1])
+				list[w++] = list[j];
+			j++;
+		}
+	}
+	data->res_start[i] = w;
+	return (0);
+}
+
+/*
+ * Builds the resource graph selected by the -t flag.
+ *
+ * Accepts ring (default), grid:<width>, hub:<count> and
+ * file:<path>. A hub count above the philosopher count would only add
+ * unused hubs and could overflow the resource count, so it is a bad
+ * spec. Returns 1 on an invalid spec or allocation failure.
+ */
+int	ft_inittopology(t_data *data)
+{
+	char	*spec;
+	int		k;
+
+	spec = data->topology;
+	if (!spec || !ft_strncmp(spec, "ring", 5))
+		return (ft_topoalloc(data, 2, data->num_philos)
+			|| ft_topogen(data, 'r', 0) || ft_csrsort(data));
+	if (!ft_strncmp(spec, "file:", 5))
+		return (ft_topofile(data, spec + 5) || ft_csrsort(data));
+	if (!ft_strncmp(spec, "grid:", 5))
+	{
+		k = ft_atoi(spec + 5);
+		if (k > 0 && data->num_philos % k == 0)
+			return (ft_topoalloc(data, 3, data->num_philos)
+				|| ft_topogen(data, 'g', k) || ft_csrsort(data));
+	}
+	if (!ft_strncmp(spec, "hub:", 4))
+	{
+		k = ft_atoi(spec + 4);
+		if (k > 0 && k <= data->num_philos)
+			return (ft_topoalloc(data, 3, data->num_philos + k)
+				|| ft_topogen(data, 'h', k) || ft_csrsort(data));
+	}
+	return (printf("Bad topology %s\n", spec), 1);
+}
@@ -0,0 +1,151 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   trace.c                                            :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: eala-lah <eala-lah@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 14:32:49 by eala-lah          #+#    #+#             */
+/*   Updated: 2026/10/19 18:37:19 by eala-lah         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/*
+ * Fills the replay log header.
+ *
+ * Besides the magic, it holds every setting that shapes the schedule:
+ * philosopher and resource counts, the command line timings, must_eat
+ * and a hash of the timing profile.
+ */
+static void	ft_traceheader(t_data *data, int *head)
+{
+	head[0] = PHILO_MAGIC;
+	head[1] = data->num_philos;
+	head[2] = data->num_forks;
+	head[3] = data->time_to_die;
+	head[4] = data->time_to_eat;
+	head[5] = data->time_to_sleep;
+	head[6] = data->must_eat;
+	head[7] = (int)data->profile_hash;
+}
+
+/*
+ * Writes a log as its length followed by its entries.
+ *
+ * Returns 1 on a failed or short write.
+ */
+static int	ft_writelog(int fd, t_log *log)
+{
+	ssize_t	size;
+
+	size = sizeof(int) * log->len;
+	if (write(fd, &log->len, sizeof(int)) != sizeof(int))
+		return (1);
+	if (size && write(fd, log->buf, size) != size)
+		return (1);
+	return (0);
+}
+
+/*
+ * Saves the recorded schedule to the -r file.
+ *
+ * Layout, all native ints: the header from ft_traceheader, then the
+ * order in which philosophers were handed their resources and the
+ * nap end offsets of every philosopher, each as a length-prefixed
+ * list.
+ * Refuses to write a recording with dropped entries, as replaying it
+ * would follow a different schedule.
+ */
+int	ft_tracesave(t_data *data)
+{
+	int	head[PHILO_HEADLEN];
+	int	fd;
+	int	i;
+	int	bad;
+
+	if (data->record_lost)
+		return (printf("Replay log %s incomplete, not saved\n",
+				data->record), 1);
+	fd = open(data->record, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+	if (fd < 0)
+		return (printf("Cannot write replay log %s\n", data->record), 1);
+	ft_traceheader(data, head);
+	bad = write(fd, head, sizeof(head)) != sizeof(head);
+	if (!bad)
+		bad = ft_writelog(fd, &data->grants);
+	i = 0;
+	while (!bad && i < data->num_philos)
+		bad = ft_writelog(fd, &data->philos[i++].naps);
+	close(fd);
+	if (bad)
+		printf("Failed writing replay log %s\n", data->record);
+	return (bad);
+}
+
+/*
+ * Copies the next length-prefixed list out of a loaded log file.
+ *
+ * With max set, every entry must be a philosopher ID in 1..max.
+ * Returns 1 if the list runs past the end of the file, holds a bad
+ * ID or memory runs out.
+ */
+static int	ft_loadlog(t_log *src, t_log *dst, int max)
+{
+	int	len;
+	int	i;
+
+	if (src->pos >= src->len)
+		return (1);
+	len = src->buf[src->pos++];
+	if (len < 0 || len > src->len - src->pos)
+		return (1);
+	i = 0;
+	while (max && i < len && src->buf[src->pos + i] >= 1
+		&& src->buf[src->pos + i] <= max)
+		i++;
+	if (max && i < len)
+		return (1);
+	dst->buf = malloc(sizeof(int) * (len + 1));
+	if (!dst->buf)
+		return (1);
+	memcpy(dst->buf, src->buf + src->pos, sizeof(int) * len);
+	dst->len = len;
+	dst->cap = len;
+	src->pos += len;
+	return (0);
+}
+
+/*
+ * Loads the -p replay log into the hand-out and philosopher logs.
+ *
+ * The header must match this run's settings, as replaying under other
+ * timings, topology or profile would silently diverge. Returns 1 on a
+ * missing, mismatched or malformed file.
+ */
+int	ft_traceload(t_data *data)
+{
+	int		head[PHILO_HEADLEN];
+	t_log	src;
+	off_t	size;
+	int		i;
+	int		bad;
+
+	src.buf = (int *)ft_readfile(data->replay, &size);
+	if (!src.buf)
+		return (printf("Cannot read replay log %s\n", data->replay), 1);
+	src.len = size / sizeof(int);
+	src.pos = PHILO_HEADLEN;
+	ft_traceheader(data, head);
+	bad = (src.len < PHILO_HEADLEN || memcmp(src.buf, head, sizeof(head)));
+	if (!bad)
+		bad = ft_loadlog(&src, &data->grants, data->num_philos);
+	i = 0;
+	while (!bad && i < data->num_philos)
+		bad = ft_loadlog(&src, &data->philos[i++].naps, 0);
+	free(src.buf);
+	if (bad)
+		return (printf("Bad replay log %s\n", data->replay), 1);
+	return (0);
+}
@@ -0,0 +1,140 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   wheel.c                                            :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: eala-lah <eala-lah@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 16:04:10 by eala-lah          #+#    #+#             */
+/*   Updated: 2026/10/19 16:04:10 by eala-lah         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/*
+ * Picks the wheel slot for a deadline.
+ *
+ * Deadlines within 256 ticks go to level 0, later ones to the first
+ * level whose range covers them. Deadlines beyond the top level are
+ * clamped to its last slot and re-sorted when it cascades.
+ */
+static int	ft_wheelslot(t_wheel *wheel, long long expires)
+{
+	long long	delta;
+	int			level;
+	int			shift;
+
+	if (expires < wheel->clock)
+		expires = wheel->clock;
+	delta = expires - wheel->clock;
+	if (delta < WHEEL_BASE)
+		return (expires & (WHEEL_BASE - 1));
+	level = 1;
+	shift = WHEEL_BITS0 + WHEEL_BITS;
+	while (level < WHEEL_LEVELS - 1 && delta >= (1LL << shift))
+	{
+		level++;
+		shift += WHEEL_BITS;
+	}
+	if (delta >= (1LL << shift))
+		expires = wheel->clock + (1LL << shift) - 1;
+	return (WHEEL_BASE + (level - 1) * WHEEL_SIZE
+		+ ((expires >> (shift - WHEEL_BITS)) & (WHEEL_SIZE - 1)));
+}
+
+/*
+ * Queues a timer in the slot matching its deadline.
+ *
+ * Caller holds the wheel lock.
+ */
+void	ft_wheeladd(t_wheel *wheel, t_timer *timer)
+{
+	int	slot;
+
+	slot = ft_wheelslot(wheel, timer->expires);
+	timer->slot = slot;
+	timer->prev = NULL;
+	timer->next = wheel->slots[slot];
+	if (timer->next)
+		timer->next->prev = timer;
+	wheel->slots[slot] = timer;
+	timer->pending = 1;
+	wheel->count++;
+}
+
+/*
+ * Unlinks a queued timer from its slot.
+ *
+ * Caller holds the wheel lock.
+ */
+void	ft_wheeldel(t_wheel *wheel, t_timer *timer)
+{
+	if (timer->prev)
+		timer->prev->next = timer->next;
+	else
+		wheel->slots[timer->slot] = timer->next;
+	if (timer->next)
+		timer->next->prev = timer->prev;
+	timer->next = NULL;
+	timer->prev = NULL;
+	timer->pending = 0;
+	wheel->count--;
+}
+
+/*
+ * Moves every timer of a higher-level slot one level down.
+ *
+ * Each timer is re-slotted relative to the current tick, so it lands
+ * in a finer level and never back in the slot being emptied.
+ */
+static void	ft_cascade(t_wheel *wheel, int slot)
+{
+	t_timer	*timer;
+	t_timer	*next;
+
+	timer = wheel->slots[slot];
+	wheel->slots[slot] = NULL;
+	while (timer)
+	{
+		next = timer->next;
+		wheel->count--;
+		ft_wheeladd(wheel, timer);
+		timer = next;
+	}
+}
+
+/*
+ * Processes the tick at the wheel clock and advances it.
+ *
+ * On a level 0 wrap, cascades the due slot of each higher level,
+ * stopping at the first level that did not wrap. Then fires every
+ * timer of the level 0 slot by setting and waking its futex word.
+ * Caller holds the wheel lock.
+ */
+void	ft_wheeltick(t_wheel *wheel)
+{
+	t_timer	*timer;
+	int		level;
+	int		idx;
+	int		shift;
+
+	level = 0;
+	idx = 0;
+	shift = WHEEL_BITS0;
+	while ((wheel->clock & (WHEEL_BASE - 1)) == 0 && idx == 0
+		&& ++level < WHEEL_LEVELS)
+	{
+		idx = (wheel->clock >> shift) & (WHEEL_SIZE - 1);
+		ft_cascade(wheel, WHEEL_BASE + (level - 1) * WHEEL_SIZE + idx);
+		shift += WHEEL_BITS;
+	}
+	while (wheel->slots[wheel->clock & (WHEEL_BASE - 1)])
+	{
+		timer = wheel->slots[wheel->clock & (WHEEL_BASE - 1)];
+		ft_wheeldel(wheel, timer);
+		__atomic_store_n(timer->wake, 1, __ATOMIC_SEQ_CST);
+		ft_futexwake(timer->wake);
+	}
+	wheel->clock++;
+}